@@ -32,18 +32,47 @@
   -------------------------------------------------------------------------*/
 
 #include "Adafruit_NeoPixel.h"
+#include "Adafruit_NeoPixel_Pace.h"
+#ifdef __AVR__
+ #include <avr/eeprom.h>
+#endif
 
-Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, uint8_t p, uint8_t t) : numLEDs(n), numBytes(n * 3), pin(p), type(t), pixels(NULL)
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, uint8_t p, uint8_t t) : numLEDs(n), numBytes(n * 3), pin(p), type(t), ownBuffer(false), pixels(NULL), capture(NULL), captureFormat(0), captureWidth(0), captureFn(NULL)
 #ifdef __AVR__
   ,port(portOutputRegister(digitalPinToPort(p))),
    pinMask(digitalPinToBitMask(p))
 #endif
 {
-  if((pixels = (uint8_t *)malloc(numBytes))) {
-    memset(pixels, 0, numBytes);
+  if(!(t & NEO_NOBUFFER)) setBuffer(NULL);
+}
+
+// Alternate constructor adopting a caller-supplied pixel buffer rather
+// than allocating one.  See setBuffer() for the ownership rules.
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, uint8_t p, uint8_t t, uint8_t *buf) : numLEDs(n), numBytes(n * 3), pin(p), type(t), ownBuffer(false), pixels(NULL), capture(NULL), captureFormat(0), captureWidth(0), captureFn(NULL)
+#ifdef __AVR__
+  ,port(portOutputRegister(digitalPinToPort(p))),
+   pinMask(digitalPinToBitMask(p))
+#endif
+{
+  setBuffer(buf);
+}
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(const Adafruit_NeoPixel &s) : numLEDs(s.numLEDs), numBytes(s.numBytes), pin(s.pin), type(s.type), ownBuffer(false), brightness(s.brightness), pixels(s.pixels), endTime(s.endTime), capture(s.capture), captureFormat(s.captureFormat), captureWidth(s.captureWidth), captureFn(s.captureFn)
+#ifdef __AVR__
+  ,port(s.port),
+   pinMask(s.pinMask)
+#endif
+{
+  if(s.ownBuffer && (pixels = (uint8_t *)malloc(numBytes))) {
+    memcpy(pixels, s.pixels, numBytes);
+    ownBuffer = true;
   }
 }
 
+Adafruit_NeoPixel::~Adafruit_NeoPixel() {
+  if(ownBuffer) free(pixels);
+}
+
 #ifdef __MK20DX128__ // Teensy 3.0
 static inline void delayShort(uint32_t) __attribute__((always_inline, unused));
 static inline void delayShort(uint32_t num) {
@@ -54,6 +83,18 @@ static inline void delayShort(uint32_t num) {
     : "+r" (num) :
   );
 }
+#ifdef NEO_ARM_CYCCNT
+// Counter and pin types for neoPaceBits() (see show()).  The DWT
+// registers are defined by the Teensy core's kinetis.h.
+struct DwtCounter {
+  uint32_t operator()() { return ARM_DWT_CYCCNT; }
+};
+struct TeensyPin {
+  volatile uint8_t *set, *clr;
+  void high(void) { *set = 1; }
+  void low(void)  { *clr = 1; }
+};
+#endif // NEO_ARM_CYCCNT
 #endif // __arm__
 
 void Adafruit_NeoPixel::begin(void) {
@@ -76,6 +117,73 @@ void Adafruit_NeoPixel::show(void) {
   // instances on different pins can be quickly issued in succession (each
   // instance doesn't delay the next).
 
+  noInterrupts(); // Need 100% focus on instruction timing
+  transmit(pixels, numBytes);
+  interrupts();
+  endTime = micros(); // Save EOD time for latch on next call
+  if(captureFn) (this->*captureFn)();
+}
+
+// Alternate show() for strips drawn procedurally: rather than reading a
+// pixel buffer, color is computed on the fly by calling gen(n, arg) for
+// each pixel, just before that pixel is sent.  Brightness and color
+// order are applied as with setPixelColor().  Works with or without a
+// pixel buffer (which is left untouched); pair with NEO_NOBUFFER to save
+// the RAM on long strips.  The catch: while each pixel is computed, the
+// data line sits low, stretching the last bit of the previous pixel.
+// The bit period only tolerates so much of that, and many WS2812B parts
+// latch after just a few microseconds idle, showing the rest of the frame
+// back at the start of the strip.  So interrupts stay off for the whole
+// frame (as with show(); millis() and serial input suffer the same way),
+// and the generator must be FAST.  The line can idle about 3.5 to 4 uS
+// between pixels before such parts latch (tests/budget_test.cpp), and
+// that has to cover transmit()'s own per-call setup as well as gen() and
+// the scaling.  Rough figures per platform -- estimated from instruction
+// counts, not measured on hardware:
+//   16 MHz AVR:  call and port setup ~60-80 cycles (4-5 uS) on its own,
+//                so only LEDs that wait out the datasheet 50 uS latch
+//                (WS2811, early WS2812) work; ~40 uS then left for gen().
+//    8 MHz AVR:  (Trinket, Gemma) same, with setup ~8-10 uS.
+//   Teensy 3.0:  setup under 1 uS; ~3 uS left, i.e. ~150 cycles at
+//                48 MHz or ~300 at 96 MHz.
+//   Due:         timer setup (pmc/TC_Configure/TC_Start) ~2-3.5 uS,
+//                leaving 1 uS or less.  Marginal with early-latch parts.
+// Table lookups, adds and shifts only; no floats, divides, micros() or
+// Serial.
+void Adafruit_NeoPixel::show(uint32_t (*gen)(uint16_t n, void *arg),
+  void *arg) {
+  uint8_t  buf[3], r, g, b;
+  uint32_t c;
+
+  while((micros() - endTime) < 50L); // See notes in show() above
+
+  noInterrupts();
+  for(uint16_t i=0; i<numLEDs; i++) {
+    c = gen(i, arg);
+    r = (uint8_t)(c >> 16);
+    g = (uint8_t)(c >>  8);
+    b = (uint8_t)c;
+    if(brightness) {
+      r = neoScale8(r, brightness - 1);
+      g = neoScale8(g, brightness - 1);
+      b = neoScale8(b, brightness - 1);
+    }
+    if((type & NEO_COLMASK) == NEO_GRB) { buf[0] = g; buf[1] = r; }
+    else                                { buf[0] = r; buf[1] = g; }
+    buf[2] = b;
+    transmit(buf, 3);
+  }
+  interrupts();
+  endTime = micros();
+}
+
+// Issue 'n' bytes from 'data' to the LEDs at the strip's pin and speed.
+// Caller is responsible for disabling interrupts and for honoring the
+// latch time before the first byte; see show() and showGroup().
+void Adafruit_NeoPixel::transmit(uint8_t *data, uint16_t n) {
+
+  if(!n) return;
+
   // In order to make this code runtime-configurable to work with any pin,
   // SBI/CBI instructions are eschewed in favor of full PORT writes via the
   // OUT or ST instructions.  It relies on two facts: that peripheral
@@ -86,14 +194,12 @@ void Adafruit_NeoPixel::show(void) {
   // state, computes 'pin high' and 'pin low' values, and writes these back
   // to the PORT register as needed.
 
-  noInterrupts(); // Need 100% focus on instruction timing
-
 #ifdef __AVR__
 
   volatile uint16_t
-    i   = numBytes; // Loop counter
+    i   = n;        // Loop counter
   volatile uint8_t
-   *ptr = pixels,   // Pointer to next byte
+   *ptr = data,     // Pointer to next byte
     b   = *ptr++,   // Current byte value
     hi,             // PORT w/output bit set high
     lo;             // PORT w/output bit set low
@@ -663,20 +769,39 @@ void Adafruit_NeoPixel::show(void) {
   // differences between flash caches hits and misses.  But it seems to
   // [run] quite well.  More testing is needed with longer strips."
 
-/* If timing can be stabilized, something like this should work:
- #define DELAY_800_T0H (0.40 * F_CPU / 1000000L / DCYC + 0.5)
- #define DELAY_800_T0L (0.85 * F_CPU / 1000000L / DCYC + 0.5)
- #define DELAY_800_T1H (0.80 * F_CPU / 1000000L / DCYC + 0.5)
- #define DELAY_800_T1L (0.45 * F_CPU / 1000000L / DCYC + 0.5)
- #define DELAY_400_T0H (0.50 * F_CPU / 1000000L / DCYC + 0.5)
- #define DELAY_400_T0L (2.00 * F_CPU / 1000000L / DCYC + 0.5)
- #define DELAY_400_T1H (1.20 * F_CPU / 1000000L / DCYC + 0.5)
- #define DELAY_400_T1L (1.30 * F_CPU / 1000000L / DCYC + 0.5)
-  But in the meantime, a fixed set of tables is used:
-*/
-
+// For the canonical Teensy 3.0 speeds (24, 48, 96 MHz), a fixed set of
+// hand-tuned tables is used.  Any other F_CPU gets delays computed from
+// the datasheet timings (see NEO_DELAY() in Adafruit_NeoPixel_Pace.h).
 #ifdef __MK20DX128__ // Teensy 3.0
 
+#ifdef NEO_ARM_CYCCNT
+
+  // Alternate Teensy 3.0 method: rather than counting out delay loops,
+  // each bit is paced off the Cortex-M4 DWT cycle counter, much like the
+  // Due code below uses TC1.  Edges are scheduled at absolute cycle
+  // counts (see neoPaceBits()), so flash cache hits and misses no longer
+  // stretch the timing, and the figures scale directly with F_CPU (no
+  // tables needed; see NEO_CYC_xxx() in Adafruit_NeoPixel_Pace.h).
+
+  DwtCounter count;
+  TeensyPin  out;
+
+  out.set = portSetRegister(pin);
+  out.clr = portClearRegister(pin);
+
+  ARM_DEMCR    |= ARM_DEMCR_TRCENA;       // Enable DWT unit
+  ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA; // Start cycle counter
+
+  if((type & NEO_SPDMASK) == NEO_KHZ800) { // 800 KHz bitstream
+    neoPaceBits(count, out, data, data + n,
+      NEO_CYC_800_T0H(F_CPU), NEO_CYC_800_T1H(F_CPU), NEO_CYC_800(F_CPU));
+  } else { // 400 KHz bitstream
+    neoPaceBits(count, out, data, data + n,
+      NEO_CYC_400_T0H(F_CPU), NEO_CYC_400_T1H(F_CPU), NEO_CYC_400(F_CPU));
+  }
+
+#else // delayShort() method
+
 #if (F_CPU == 24000000)
  #define DELAY_800_T0H  2
  #define DELAY_800_T0L  4
@@ -705,15 +830,26 @@ void Adafruit_NeoPixel::show(void) {
  #define DELAY_400_T1H 36
  #define DELAY_400_T1L 22
 #else
- #error "CPU SPEED NOT SUPPORTED"
+ #if (NEO_800_T0H(F_CPU) >= NEO_800_T1H(F_CPU)) || \
+     (NEO_400_T0H(F_CPU) >= NEO_400_T1H(F_CPU))
+  #error "F_CPU too slow to tell NeoPixel '0' and '1' bits apart"
+ #endif
+ #define DELAY_800_T0H NEO_800_T0H(F_CPU)
+ #define DELAY_800_T0L NEO_800_T0L(F_CPU)
+ #define DELAY_800_T1H NEO_800_T1H(F_CPU)
+ #define DELAY_800_T1L NEO_800_T1L(F_CPU)
+ #define DELAY_400_T0H NEO_400_T0H(F_CPU)
+ #define DELAY_400_T0L NEO_400_T0L(F_CPU)
+ #define DELAY_400_T1H NEO_400_T1H(F_CPU)
+ #define DELAY_400_T1L NEO_400_T1L(F_CPU)
 #endif
 
   volatile uint8_t *set = portSetRegister(pin);
   volatile uint8_t *clr = portClearRegister(pin);
   #define SET_HI   *set = 1;
   #define SET_LO   *clr = 1;
-  uint8_t *p   = pixels,
-          *end = p + numBytes, pix, mask;
+  uint8_t *p   = data,
+          *end = p + n, pix, mask;
 
   if((type & NEO_SPDMASK) == NEO_KHZ800) { // 800 KHz bitstream
     while(p < end) {
@@ -749,6 +885,8 @@ void Adafruit_NeoPixel::show(void) {
     }
   }
 
+#endif // NEO_ARM_CYCCNT
+
 #else // Arduino Due
 
   #define SCALE      VARIANT_MCK / 2UL / 1000000UL
@@ -777,8 +915,8 @@ void Adafruit_NeoPixel::show(void) {
   portClear = &(port->PIO_CODR);            // starting timer to minimize
   timeValue = &(TC1->TC_CHANNEL[0].TC_CV);  // the initial 'while'.
   timeReset = &(TC1->TC_CHANNEL[0].TC_CCR);
-  p         =  pixels;
-  end       =  p + numBytes;
+  p         =  data;
+  end       =  p + n;
   pix       = *p++;
   mask      = 0x80;
 
@@ -811,19 +949,72 @@ void Adafruit_NeoPixel::show(void) {
 #endif // end Arduino Due
 
 #endif // end Architecture select
+}
 
+// Issue several strips back-to-back in a single interrupts-off window.
+// Calling show() on each in turn works, but each call separately waits
+// out its own latch and toggles interrupts.  Here, strips are sorted
+// oldest-frame-first (NOTE: the passed array is reordered in place), and
+// since each later strip's latch keeps elapsing while the ones ahead of
+// it are being sent, one up-front wait covering whichever strip needs it
+// most is all that's required.  Transmit times are estimated from the
+// nominal bit rate; actual output is never faster, so the estimate errs
+// on the safe side.  Keep in mind interrupts stay off for the whole
+// group, so millis() and serial input will suffer accordingly.  Strips
+// without a pixel buffer are skipped.  Returns total elapsed time for
+// the group, including any latch wait, in microseconds.
+uint32_t Adafruit_NeoPixel::showGroup(Adafruit_NeoPixel *strips[],
+  uint8_t count) {
+  Adafruit_NeoPixel *s;
+  uint8_t            i, j;
+  uint32_t           start, elapsed, t;
+  int32_t            wait = 0, before = 0, need;
+
+  for(i=1; i<count; i++) { // Insertion sort, oldest endTime first
+    s = strips[i];
+    for(j=i; (j > 0) && ((int32_t)(strips[j-1]->endTime - s->endTime) > 0);
+      j--) strips[j] = strips[j-1];
+    strips[j] = s;
+  }
+
+  start = micros();
+  for(i=0; i<count; i++) {
+    s = strips[i];
+    if(!s->pixels) continue;
+    elapsed = start - s->endTime;
+    if(elapsed < 50L) {
+      need = 50L - (int32_t)elapsed - before;
+      if(need > wait) wait = need;
+    }
+    before += (int32_t)s->numBytes *
+      (((s->type & NEO_SPDMASK) == NEO_KHZ800) ? 10 : 20);
+  }
+  while((int32_t)(micros() - start) < wait);
+
+  noInterrupts();
+  for(i=0; i<count; i++) {
+    s = strips[i];
+    if(s->pixels) s->transmit(s->pixels, s->numBytes);
+  }
   interrupts();
-  endTime = micros(); // Save EOD time for latch on next call
+
+  t = micros();
+  for(i=0; i<count; i++) {
+    s          = strips[i];
+    s->endTime = t;
+    if(s->captureFn && s->pixels) (s->*(s->captureFn))();
+  }
+  return t - start;
 }
 
 // Set pixel color from separate R,G,B components:
 void Adafruit_NeoPixel::setPixelColor(
  uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
-  if(n < numLEDs) {
+  if((n < numLEDs) && pixels) {
     if(brightness) { // See notes in setBrightness()
-      r = (r * brightness) >> 8;
-      g = (g * brightness) >> 8;
-      b = (b * brightness) >> 8;
+      r = neoScale8(r, brightness - 1);
+      g = neoScale8(g, brightness - 1);
+      b = neoScale8(b, brightness - 1);
     }
     uint8_t *p = &pixels[n * 3];
     if((type & NEO_COLMASK) == NEO_GRB) { *p++ = g; *p++ = r; }
@@ -834,15 +1025,15 @@ void Adafruit_NeoPixel::setPixelColor(
 
 // Set pixel color from 'packed' 32-bit RGB color:
 void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c) {
-  if(n < numLEDs) {
+  if((n < numLEDs) && pixels) {
     uint8_t
       r = (uint8_t)(c >> 16),
       g = (uint8_t)(c >>  8),
       b = (uint8_t)c;
     if(brightness) { // See notes in setBrightness()
-      r = (r * brightness) >> 8;
-      g = (g * brightness) >> 8;
-      b = (b * brightness) >> 8;
+      r = neoScale8(r, brightness - 1);
+      g = neoScale8(g, brightness - 1);
+      b = neoScale8(b, brightness - 1);
     }
     uint8_t *p = &pixels[n * 3];
     if((type & NEO_COLMASK) == NEO_GRB) { *p++ = g; *p++ = r; }
@@ -860,7 +1051,7 @@ uint32_t Adafruit_NeoPixel::Color(uint8_t r, uint8_t g, uint8_t b) {
 // Query color from previously-set pixel (returns packed 32-bit RGB value)
 uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) {
 
-  if(n < numLEDs) {
+  if((n < numLEDs) && pixels) {
     uint16_t ofs = n * 3;
     return (uint32_t)(pixels[ofs + 2]) |
       (((type & NEO_COLMASK) == NEO_GRB) ?
@@ -878,6 +1069,36 @@ uint16_t Adafruit_NeoPixel::numPixels(void) {
   return numLEDs;
 }
 
+// Direct access to the pixel buffer (numPixels() * 3 bytes, in the strip's
+// native color order, already scaled by the current brightness).  May be
+// NULL if allocation failed.  Use with care!
+uint8_t *Adafruit_NeoPixel::getPixels(void) {
+  return pixels;
+}
+
+// Switch this strip to a different pixel buffer.  If 'buf' is non-NULL,
+// it must point to at least numPixels() * 3 bytes; the memory remains
+// owned by the caller, is NOT cleared (so a frame may be pre-loaded in
+// place) and must outlive this object or the next setBuffer() call.
+// Several strips may point into one larger array, making each a 'view'
+// on part of a single contiguous frame.  Contents are interpreted as
+// already scaled by the current brightness, same as setPixelColor()
+// output.  Passing NULL returns to a malloc()ed buffer owned (and later
+// freed) by the object, cleared to black.  Any previously owned buffer
+// is freed either way, so pointers from getPixels() are then invalid.
+void Adafruit_NeoPixel::setBuffer(uint8_t *buf) {
+  if(ownBuffer) {
+    free(pixels);
+    ownBuffer = false;
+  }
+  if(buf) {
+    pixels = buf;
+  } else if((pixels = (uint8_t *)malloc(numBytes))) {
+    memset(pixels, 0, numBytes);
+    ownBuffer = true;
+  }
+}
+
 // Adjust output brightness; 0=darkest (off), 255=brightest.  This does
 // NOT immediately affect what's currently displayed on the LEDs.  The
 // next call to show() will refresh the LEDs at this level.  However,
@@ -900,17 +1121,253 @@ void Adafruit_NeoPixel::setBrightness(uint8_t b) {
   uint8_t newBrightness = b + 1;
   if(newBrightness != brightness) { // Compare against prior value
     // Brightness has changed -- re-scale existing data in RAM
-    uint8_t  c,
-            *ptr           = pixels,
-             oldBrightness = brightness - 1; // De-wrap old brightness value
-    uint16_t scale;
-    if(oldBrightness == 0) scale = 0; // Avoid /0
-    else if(b == 255) scale = 65535 / oldBrightness;
-    else scale = (((uint16_t)newBrightness << 8) - 1) / oldBrightness;
-    for(uint16_t i=0; i<numBytes; i++) {
-      c      = *ptr;
-      *ptr++ = (c * scale) >> 8;
-    }
+    if(pixels) neoRescaleBuffer(pixels, numBytes, brightness - 1, b);
     brightness = newBrightness;
   }
 }
+
+// Frame capture: when enabled, every show() (after the data has gone out
+// and interrupts are back on) writes a record of the frame to 'out',
+// typically Serial, for saving and later analysis or playback (see the
+// 'replay' example).  Each record is:
+//   1 byte    'F' (record marker)
+//   4 bytes   micros() at end of frame, little-endian
+//   1 byte    brightness (as passed to setBrightness())
+//   2 bytes   number of data bytes that follow, little-endian
+//   1 byte    type flags (NEO_GRB, NEO_KHZ800, etc.)
+//   n bytes   pixel data exactly as issued (strip color order, brightness
+//             already applied)
+// Logging is slow -- 60 pixels at 115200 baud is about 16 mS -- and adds
+// directly to the frame time.  Generator show() frames aren't logged,
+// since there is no buffer to record.  Pass NULL to stop capturing.
+void Adafruit_NeoPixel::setCapture(Print *out) {
+  capture   = out;
+  captureFn = out ? &Adafruit_NeoPixel::captureFrame : NULL;
+}
+
+// Alternate capture mode: each frame is written as a binary PPM image,
+// in RGB order regardless of strip type, for viewing the output without
+// the LEDs attached.  'width' sets pixels per row for matrices (0 = whole
+// strip in one row); add NEO_CAPTURE_ZIGZAG for matrices wired in
+// serpentine order.  Any unused spots in the last row are black.  LEDs
+// emit light in proportion to their values while screens expect
+// gamma-encoded values, so raw captures look darker than the real thing;
+// NEO_CAPTURE_GAMMA applies the inverse (1/2.2) curve to compensate.  The
+// resulting stream is simply one image after another, which most image
+// and video tools will read directly, e.g.:
+//   ffmpeg -f image2pipe -c:v ppm -i frames.ppm frames.gif
+// Kept separate from setCapture() so the image code and gamma table are
+// only linked into sketches that call this.  Pass NULL to stop.
+void Adafruit_NeoPixel::setCapturePPM(Print *out, uint8_t flags,
+  uint16_t width) {
+  capture       = out;
+  captureFn     = out ? &Adafruit_NeoPixel::capturePPM : NULL;
+  captureFormat = flags;
+  captureWidth  = (width && (width < numLEDs)) ? width : numLEDs;
+}
+
+// Encode linear LED brightness for display on a gamma 2.2 screen
+static const uint8_t PROGMEM displayGamma[] = {
+     0, 21, 28, 34, 39, 43, 46, 50, 53, 56, 59, 61, 64, 66, 68, 70,
+    72, 74, 76, 78, 80, 82, 84, 85, 87, 89, 90, 92, 93, 95, 96, 98,
+    99,101,102,103,105,106,107,109,110,111,112,114,115,116,117,118,
+   119,120,122,123,124,125,126,127,128,129,130,131,132,133,134,135,
+   136,137,138,139,140,141,142,143,144,144,145,146,147,148,149,150,
+   151,151,152,153,154,155,156,156,157,158,159,160,160,161,162,163,
+   164,164,165,166,167,167,168,169,170,170,171,172,173,173,174,175,
+   175,176,177,178,178,179,180,180,181,182,182,183,184,184,185,186,
+   186,187,188,188,189,190,190,191,192,192,193,194,194,195,195,196,
+   197,197,198,199,199,200,200,201,202,202,203,203,204,205,205,206,
+   206,207,207,208,209,209,210,210,211,212,212,213,213,214,214,215,
+   215,216,217,217,218,218,219,219,220,220,221,221,222,223,223,224,
+   224,225,225,226,226,227,227,228,228,229,229,230,230,231,231,232,
+   232,233,233,234,234,235,235,236,236,237,237,238,238,239,239,240,
+   240,241,241,242,242,243,243,244,244,245,245,246,246,247,247,248,
+   248,249,249,249,250,250,251,251,252,252,253,253,254,254,255,255
+};
+
+void Adafruit_NeoPixel::capturePPM(void) {
+  uint16_t w    = captureWidth ? captureWidth : 1,
+           h    = (numLEDs + w - 1) / w,
+           x, y, i;
+  uint8_t  rgb[3], *p, rOfs, gOfs;
+
+  if((type & NEO_COLMASK) == NEO_GRB) { rOfs = 1; gOfs = 0; }
+  else                                { rOfs = 0; gOfs = 1; }
+
+  capture->print("P6\n");
+  capture->print(w);
+  capture->print(" ");
+  capture->print(h);
+  capture->print("\n255\n");
+
+  for(y=0; y<h; y++) {
+    for(x=0; x<w; x++) {
+      i = y * w;
+      i += ((captureFormat & NEO_CAPTURE_ZIGZAG) && (y & 1)) ?
+        (w - 1 - x) : x;
+      if(i < numLEDs) {
+        p      = &pixels[i * 3];
+        rgb[0] = p[rOfs];
+        rgb[1] = p[gOfs];
+        rgb[2] = p[2];
+        if(captureFormat & NEO_CAPTURE_GAMMA) {
+          rgb[0] = pgm_read_byte(&displayGamma[rgb[0]]);
+          rgb[1] = pgm_read_byte(&displayGamma[rgb[1]]);
+          rgb[2] = pgm_read_byte(&displayGamma[rgb[2]]);
+        }
+      } else {
+        rgb[0] = rgb[1] = rgb[2] = 0;
+      }
+      capture->write(rgb, 3);
+    }
+  }
+}
+
+void Adafruit_NeoPixel::captureFrame(void) {
+  uint8_t hdr[9];
+  hdr[0] = 'F';
+  hdr[1] = endTime;
+  hdr[2] = endTime >>  8;
+  hdr[3] = endTime >> 16;
+  hdr[4] = endTime >> 24;
+  hdr[5] = brightness - 1; // De-wrap stored brightness
+  hdr[6] = numBytes;
+  hdr[7] = numBytes >> 8;
+  hdr[8] = type;
+  capture->write(hdr, sizeof(hdr));
+  capture->write(pixels, numBytes);
+}
+
+// Snapshots: save the pixel buffer somewhere and later put it back in one
+// pass, e.g. to flip between a few fixed displays without redrawing them
+// pixel by pixel.  A snapshot is just the raw buffer contents (native
+// color order, brightness already applied), so restore it at the same
+// brightness it was saved with.  With NEO_SNAP_RLE, data is stored as
+// 4-byte runs instead: a repeat count (1-255) followed by one pixel's
+// 3 bytes.  Solid colors and large black areas compress very well; busy
+// images can come out larger than raw.
+
+// Read or write one byte of snapshot data at 'i' in the given memory.
+static uint8_t snapGet(const void *src, uint16_t i, uint8_t flags) {
+  switch(flags & NEO_SNAP_MEMMASK) {
+   case NEO_SNAP_PROGMEM:
+    return pgm_read_byte((const uint8_t *)src + i);
+#ifdef __AVR__
+   case NEO_SNAP_EEPROM:
+    return eeprom_read_byte((const uint8_t *)src + i);
+#endif
+   default:
+    return ((const uint8_t *)src)[i];
+  }
+}
+
+static void snapPut(void *dest, uint16_t i, uint8_t c, uint8_t flags) {
+#ifdef __AVR__
+  if((flags & NEO_SNAP_MEMMASK) == NEO_SNAP_EEPROM) {
+    eeprom_update_byte((uint8_t *)dest + i, c); // Skips unchanged bytes
+    return;
+  }
+#else
+  (void)flags; // Only RAM is writable here
+#endif
+  ((uint8_t *)dest)[i] = c;
+}
+
+// Length of the run of identical pixels starting at byte 'i' (1-255).
+static uint8_t snapRun(const uint8_t *pixels, uint16_t i, uint16_t n) {
+  const uint8_t *p = &pixels[i];
+  uint8_t        run = 1;
+  for(i += 3; (i < n) && (run < 255) &&
+    (pixels[i] == p[0]) && (pixels[i+1] == p[1]) && (pixels[i+2] == p[2]);
+    i += 3) run++;
+  return run;
+}
+
+// Save pixel buffer to 'dest' (RAM, or EEPROM address on AVR), which has
+// room for 'len' bytes.  Returns number of bytes written, or 0 if it
+// didn't fit or the memory type can't be written (PROGMEM: save to RAM,
+// print it out and paste into a const PROGMEM array instead).  When 0 is
+// returned, nothing at 'dest' has been touched, so a failed save never
+// clobbers an earlier snapshot there.  Raw snapshots always take
+// numPixels() * 3 bytes.
+uint16_t Adafruit_NeoPixel::saveSnapshot(void *dest, uint16_t len,
+  uint8_t flags) {
+  uint8_t mem = flags & NEO_SNAP_MEMMASK;
+  if(!pixels || (mem == NEO_SNAP_PROGMEM)) return 0;
+#ifndef __AVR__
+  if(mem == NEO_SNAP_EEPROM) return 0;
+#endif
+
+  if(!(flags & NEO_SNAP_RLE)) {
+    if(len < numBytes) return 0;
+    if(mem == NEO_SNAP_RAM) memcpy(dest, pixels, numBytes);
+    else for(uint16_t i=0; i<numBytes; i++) snapPut(dest, i, pixels[i], flags);
+    return numBytes;
+  }
+
+  // Size the encoded data first, so nothing is written unless it all fits
+  uint16_t out = 0, i;
+  uint8_t  run;
+  for(i=0; i<numBytes; i += snapRun(pixels, i, numBytes) * 3) {
+    if((out + 4) > len) return 0;
+    out += 4;
+  }
+
+  for(i=out=0; i<numBytes; i += run * 3) {
+    run = snapRun(pixels, i, numBytes);
+    snapPut(dest, out++, run        , flags);
+    snapPut(dest, out++, pixels[i  ], flags);
+    snapPut(dest, out++, pixels[i+1], flags);
+    snapPut(dest, out++, pixels[i+2], flags);
+  }
+  return out;
+}
+
+// Load pixel buffer from a snapshot made by saveSnapshot() (or an
+// equivalent PROGMEM table), using the same flags.  'len' is the size of
+// the snapshot data (as returned by saveSnapshot()); nothing past it is
+// ever read.  Does not call show().  Returns false if there's no pixel
+// buffer, the memory type isn't supported here, or the data is too short
+// or malformed (with RLE, the buffer may then be partly overwritten).
+boolean Adafruit_NeoPixel::restoreSnapshot(const void *src, uint16_t len,
+  uint8_t flags) {
+  uint8_t mem = flags & NEO_SNAP_MEMMASK;
+  if(!pixels) return false;
+#ifndef __AVR__
+  if(mem == NEO_SNAP_EEPROM) return false;
+#endif
+
+  if(!(flags & NEO_SNAP_RLE)) {
+    if(len < numBytes) return false;
+    switch(mem) {
+     case NEO_SNAP_PROGMEM:
+      memcpy_P(pixels, src, numBytes);
+      break;
+#ifdef __AVR__
+     case NEO_SNAP_EEPROM:
+      eeprom_read_block(pixels, src, numBytes);
+      break;
+#endif
+     default:
+      memcpy(pixels, src, numBytes);
+    }
+    return true;
+  }
+
+  uint16_t in = 0;
+  for(uint16_t i=0; i<numBytes; ) {
+    if((in + 4) > len) return false; // Ran out of data
+    uint8_t run = snapGet(src, in++, flags),
+            c0  = snapGet(src, in++, flags),
+            c1  = snapGet(src, in++, flags),
+            c2  = snapGet(src, in++, flags);
+    if(!run || ((i + run * 3) > numBytes)) return false;
+    while(run--) {
+      pixels[i++] = c0;
+      pixels[i++] = c1;
+      pixels[i++] = c2;
+    }
+  }
+  return true;
+}
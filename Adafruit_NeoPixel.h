@@ -25,6 +25,7 @@
  #include <WProgram.h>
  #include <pins_arduino.h>
 #endif
+#include "Adafruit_NeoPixel_Math.h"
 
 // 'type' flags for LED pixels (third parameter to constructor):
 #define NEO_RGB     0x00 // Wired for RGB data order
@@ -33,6 +34,22 @@
 #define NEO_KHZ400  0x00 // 400 KHz datastream
 #define NEO_KHZ800  0x02 // 800 KHz datastream
 #define NEO_SPDMASK 0x02
+#define NEO_NOBUFFER 0x04 // No pixel buffer; for show(gen) only
+
+// 'flags' for saveSnapshot() and restoreSnapshot():
+#define NEO_SNAP_RAM     0x00 // Snapshot is in RAM
+#define NEO_SNAP_PROGMEM 0x01 // Snapshot is in flash (restore only)
+#define NEO_SNAP_EEPROM  0x02 // Snapshot is in EEPROM (AVR only)
+#define NEO_SNAP_MEMMASK 0x03
+#define NEO_SNAP_RLE     0x04 // Snapshot is run-length encoded
+
+// 'flags' for setCapturePPM():
+#define NEO_CAPTURE_ZIGZAG 0x01 // Matrix rows alternate direction
+#define NEO_CAPTURE_GAMMA  0x02 // Colors corrected for screen display
+
+// Uncomment to pace Teensy 3.0 output off the ARM DWT cycle counter
+// instead of calibrated delay loops (see show() for details).
+//#define NEO_ARM_CYCCNT
 
 class Adafruit_NeoPixel {
 
@@ -40,33 +57,74 @@ class Adafruit_NeoPixel {
 
   // Constructor: number of LEDs, pin number, LED type
   Adafruit_NeoPixel(uint16_t n, uint8_t p=6, uint8_t t=NEO_GRB + NEO_KHZ800);
+  // Constructor using caller-owned pixel memory (n * 3 bytes, see setBuffer())
+  Adafruit_NeoPixel(uint16_t n, uint8_t p, uint8_t t, uint8_t *buf);
+  // Copies get their own pixel buffer if the original owns one (external
+  // buffers are shared), so two objects never free the same memory.
+  Adafruit_NeoPixel(const Adafruit_NeoPixel &s);
+  ~Adafruit_NeoPixel();
 
   void
     begin(void),
     show(void),
+    show(uint32_t (*gen)(uint16_t n, void *arg), void *arg=NULL),
     setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b),
     setPixelColor(uint16_t n, uint32_t c),
-    setBrightness(uint8_t);
+    setBrightness(uint8_t),
+    setBuffer(uint8_t *buf),
+    setCapture(Print *out),
+    setCapturePPM(Print *out, uint8_t flags=0, uint16_t width=0);
+  boolean
+    restoreSnapshot(const void *src, uint16_t len,
+      uint8_t flags=NEO_SNAP_RAM);
   uint16_t
-    numPixels(void);
+    numPixels(void),
+    saveSnapshot(void *dest, uint16_t len, uint8_t flags=NEO_SNAP_RAM);
+  uint8_t
+   *getPixels(void);
   static uint32_t
-    Color(uint8_t r, uint8_t g, uint8_t b);
+    Color(uint8_t r, uint8_t g, uint8_t b),
+    showGroup(Adafruit_NeoPixel *strips[], uint8_t count);
   uint32_t
     getPixelColor(uint16_t n);
 
  private:
 
+  // Not assignable (declared, never defined)
+  Adafruit_NeoPixel
+   &operator=(const Adafruit_NeoPixel &);
+
+  // Never inlined: the AVR assembly in it uses fixed labels, which would
+  // be duplicated if the compiler copied it into more than one caller.
+  void
+    transmit(uint8_t *data, uint16_t n) __attribute__((noinline)),
+    captureFrame(void),
+    capturePPM(void);
+
   const uint16_t
     numLEDs,       // Number of RGB LEDs in strip
     numBytes;      // Size of 'pixels' buffer below
   const uint8_t
     pin,           // Output pin number
     type;          // Pixel flags (400 vs 800 KHz, RGB vs GRB color)
+  boolean
+    ownBuffer;     // If true, 'pixels' was malloc()ed here and is freed here
   uint8_t
     brightness,
    *pixels;        // Holds LED color values (3 bytes each)
   uint32_t
     endTime;       // Latch timing reference
+  Print
+   *capture;       // If set, each frame shown is logged here
+  uint8_t
+    captureFormat; // NEO_CAPTURE_* flags for setCapturePPM()
+  uint16_t
+    captureWidth;  // Image width (pixels per row) for setCapturePPM()
+  // Frame logger called by show(), or NULL.  Only setCapture() and
+  // setCapturePPM() refer to the logging code, so sketches don't link
+  // what they never use.
+  void
+    (Adafruit_NeoPixel::*captureFn)(void);
 #ifdef __AVR__
   const volatile uint8_t
     *port;         // Output PORT register
@@ -0,0 +1,223 @@
+/*-------------------------------------------------------------------------
+  Non-blocking effect engine for the Adafruit NeoPixel library.  Effects
+  are advanced a frame at a time from loop() instead of spinning in
+  delay(), so sketches can keep reading inputs while animating, and
+  several effects on different segments can run side by side.
+
+  -------------------------------------------------------------------------
+  This file is part of the Adafruit NeoPixel library.
+
+  NeoPixel is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation, either version 3 of
+  the License, or (at your option) any later version.
+
+  NeoPixel is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with NeoPixel.  If not, see
+  <http://www.gnu.org/licenses/>.
+  -------------------------------------------------------------------------*/
+
+#include "Adafruit_NeoPixel_Effect.h"
+
+// Effect base class ------------------------------------------------------
+
+Adafruit_NeoPixel_Effect::Adafruit_NeoPixel_Effect(
+  Adafruit_NeoPixel_Segment &s, uint16_t ms) : segment(s), frame(0),
+  finished(false), lastStep(0), lastRender(0), maxRender(0), interval(ms),
+  pending(true), complete(false)
+{
+}
+
+// Advance effect if it's due.  'now' is the current millis() value,
+// passed in so all effects in one engine pass see the same time.  Returns
+// true if pixels were changed (i.e. a show() is needed).
+boolean Adafruit_NeoPixel_Effect::tick(uint32_t now) {
+  if(complete) return false;
+  if(!pending && ((now - lastStep) < interval)) return false;
+  if(finished) { // Final frame has now been displayed for its interval
+    complete = true;
+    return false;
+  }
+  pending  = false;
+  lastStep = now;
+
+  uint32_t t       = micros();
+  boolean  changed = step();
+  lastRender       = micros() - t;
+  if(lastRender > maxRender) maxRender = lastRender;
+  frame++;
+
+  return changed;
+}
+
+// Start effect over from its first frame, which will be rendered on the
+// next tick() regardless of interval.
+void Adafruit_NeoPixel_Effect::restart(void) {
+  frame     = 0;
+  finished  = false;
+  complete  = false;
+  pending   = true;
+  maxRender = 0;
+  reset();
+}
+
+// True once a one-shot effect's last frame has been drawn AND has stayed
+// up for a full interval, same as a delay() after the final frame would
+// have held it.  Always false for endless effects.
+boolean Adafruit_NeoPixel_Effect::done(void) {
+  return complete;
+}
+
+void Adafruit_NeoPixel_Effect::setInterval(uint16_t ms) {
+  interval = ms;
+}
+
+// Time taken by most recent step(), in microseconds.
+uint32_t Adafruit_NeoPixel_Effect::renderTime(void) {
+  return lastRender;
+}
+
+// Worst-case step() time since last restart(), in microseconds.
+uint32_t Adafruit_NeoPixel_Effect::maxRenderTime(void) {
+  return maxRender;
+}
+
+// Engine -----------------------------------------------------------------
+
+Adafruit_NeoPixel_Engine::Adafruit_NeoPixel_Engine(Adafruit_NeoPixel &s) :
+  strip(s), count(0), lastShow(0)
+{
+}
+
+// Add effect to engine (no-op if already present).  Effects are ticked in
+// the order added, so where segments overlap, later ones draw on top.
+// Returns false if the engine is full (see NEO_MAX_EFFECTS).
+boolean Adafruit_NeoPixel_Engine::add(Adafruit_NeoPixel_Effect &e) {
+  for(uint8_t i=0; i<count; i++) {
+    if(effects[i] == &e) return true;
+  }
+  if(count >= NEO_MAX_EFFECTS) return false;
+  effects[count++] = &e;
+  return true;
+}
+
+void Adafruit_NeoPixel_Engine::remove(Adafruit_NeoPixel_Effect &e) {
+  for(uint8_t i=0; i<count; i++) {
+    if(effects[i] == &e) {
+      for(count--; i<count; i++) effects[i] = effects[i + 1];
+      return;
+    }
+  }
+}
+
+void Adafruit_NeoPixel_Engine::removeAll(void) {
+  count = 0;
+}
+
+uint8_t Adafruit_NeoPixel_Engine::numEffects(void) {
+  return count;
+}
+
+// Advance all effects that are due and, if any pixels changed, refresh
+// the strip once.  Returns true if show() was called.
+boolean Adafruit_NeoPixel_Engine::tick(uint32_t now) {
+  boolean changed = false;
+  for(uint8_t i=0; i<count; i++) {
+    if(effects[i]->tick(now)) changed = true;
+  }
+  if(changed) {
+    uint32_t t = micros();
+    strip.show();
+    lastShow = micros() - t;
+  }
+  return changed;
+}
+
+boolean Adafruit_NeoPixel_Engine::tick(void) {
+  return tick(millis());
+}
+
+// Duration of most recent show() in microseconds (includes any wait for
+// the previous frame's latch).
+uint32_t Adafruit_NeoPixel_Engine::showTime(void) {
+  return lastShow;
+}
+
+// Stock effects ----------------------------------------------------------
+
+Adafruit_NeoPixel_Solid::Adafruit_NeoPixel_Solid(
+  Adafruit_NeoPixel_Segment &s, uint32_t c) :
+  Adafruit_NeoPixel_Effect(s), color(c)
+{
+}
+
+void Adafruit_NeoPixel_Solid::setColor(uint32_t c) {
+  color = c;
+  restart();
+}
+
+boolean Adafruit_NeoPixel_Solid::step(void) {
+  segment.fill(color);
+  finished = true;
+  return true;
+}
+
+Adafruit_NeoPixel_ColorWipe::Adafruit_NeoPixel_ColorWipe(
+  Adafruit_NeoPixel_Segment &s, uint32_t c, uint16_t ms) :
+  Adafruit_NeoPixel_Effect(s, ms), color(c)
+{
+}
+
+void Adafruit_NeoPixel_ColorWipe::setColor(uint32_t c) {
+  color = c;
+  restart();
+}
+
+boolean Adafruit_NeoPixel_ColorWipe::step(void) {
+  if(frame >= segment.numPixels()) {
+    finished = true;
+    return false;
+  }
+  segment.setPixelColor(frame, color);
+  if((frame + 1) >= segment.numPixels()) finished = true;
+  return true;
+}
+
+Adafruit_NeoPixel_Sparkle::Adafruit_NeoPixel_Sparkle(
+  Adafruit_NeoPixel_Segment &s, uint32_t c, uint16_t ms) :
+  Adafruit_NeoPixel_Effect(s, ms), color(c), last(0xFFFF)
+{
+}
+
+void Adafruit_NeoPixel_Sparkle::reset(void) {
+  last = 0xFFFF;
+}
+
+boolean Adafruit_NeoPixel_Sparkle::step(void) {
+  if(!segment.numPixels()) return false;
+  if(last != 0xFFFF) segment.setPixelColor(last, 0); // Erase prior pixel
+  last = random(segment.numPixels());
+  segment.setPixelColor(last, color);
+  return true;
+}
+
+Adafruit_NeoPixel_FadeIn::Adafruit_NeoPixel_FadeIn(
+  Adafruit_NeoPixel_Segment &s, uint32_t c, uint16_t n, uint16_t ms) :
+  Adafruit_NeoPixel_Effect(s, ms), color(c), steps(n ? n : 1)
+{
+}
+
+boolean Adafruit_NeoPixel_FadeIn::step(void) {
+  uint16_t level = frame + 1;
+  if(level >= steps) {
+    level    = steps;
+    finished = true;
+  }
+  segment.fill(neoScaleColor(color, (uint32_t)level * 255 / steps));
+  return true;
+}
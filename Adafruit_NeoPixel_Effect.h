@@ -0,0 +1,170 @@
+/*--------------------------------------------------------------------
+  This file is part of the Adafruit NeoPixel library.
+
+  NeoPixel is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation, either version 3 of
+  the License, or (at your option) any later version.
+
+  NeoPixel is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with NeoPixel.  If not, see
+  <http://www.gnu.org/licenses/>.
+  --------------------------------------------------------------------*/
+
+#ifndef ADAFRUIT_NEOPIXEL_EFFECT_H
+#define ADAFRUIT_NEOPIXEL_EFFECT_H
+
+#include "Adafruit_NeoPixel_Segment.h"
+
+// Maximum number of effects one engine can run concurrently.  Fixed
+// array, no dynamic allocation; raise if needed (2 bytes RAM each on AVR).
+#ifndef NEO_MAX_EFFECTS
+ #define NEO_MAX_EFFECTS 8
+#endif
+
+// Base class for non-blocking effects.  An effect is a small state
+// machine drawing into one segment: rather than looping with delay(),
+// subclasses implement step(), which renders ONE frame and returns.
+// tick() calls step() whenever 'interval' milliseconds have passed and
+// records how long rendering took.  Effects never call show() themselves;
+// that's left to the engine (or the sketch) so several effects can share
+// a single show() per frame.
+
+class Adafruit_NeoPixel_Effect {
+
+ public:
+
+  // Constructor: segment to draw in, milliseconds between frames
+  Adafruit_NeoPixel_Effect(Adafruit_NeoPixel_Segment &s, uint16_t ms=0);
+  virtual ~Adafruit_NeoPixel_Effect() {}
+
+  boolean
+    tick(uint32_t now),
+    done(void);
+  void
+    restart(void),
+    setInterval(uint16_t ms);
+  uint32_t
+    renderTime(void),
+    maxRenderTime(void);
+
+ protected:
+
+  // Render next frame; return true if any pixels changed.  Set 'finished'
+  // for effects that run once and then stop.
+  virtual boolean
+    step(void) = 0;
+  // Called by restart() to return effect-specific state to the start.
+  virtual void
+    reset(void) {}
+
+  Adafruit_NeoPixel_Segment
+   &segment;       // Where this effect draws
+  uint16_t
+    frame;         // Number of step() calls since restart()
+  boolean
+    finished;      // Set by step() when drawing a one-shot effect's last frame
+
+ private:
+
+  uint32_t
+    lastStep,      // millis() time of last step()
+    lastRender,    // Duration of last step() in microseconds
+    maxRender;     // Longest step() since restart(), in microseconds
+  uint16_t
+    interval;      // Milliseconds between steps
+  boolean
+    pending,       // If true, step on next tick() regardless of time
+    complete;      // Last frame has been up for a full interval; see done()
+
+};
+
+// Runs any number (up to NEO_MAX_EFFECTS) of effects on segments of one
+// strip.  Call tick() often from loop(); it advances whichever effects
+// are due and, if any of them changed pixels, issues ONE show() for all.
+
+class Adafruit_NeoPixel_Engine {
+
+ public:
+
+  Adafruit_NeoPixel_Engine(Adafruit_NeoPixel &s);
+
+  boolean
+    add(Adafruit_NeoPixel_Effect &e),
+    tick(uint32_t now),
+    tick(void);
+  void
+    remove(Adafruit_NeoPixel_Effect &e),
+    removeAll(void);
+  uint8_t
+    numEffects(void);
+  uint32_t
+    showTime(void);
+
+ private:
+
+  Adafruit_NeoPixel
+   &strip;
+  Adafruit_NeoPixel_Effect
+   *effects[NEO_MAX_EFFECTS];
+  uint8_t
+    count;         // Number of active entries in effects[]
+  uint32_t
+    lastShow;      // Duration of last show() in microseconds
+
+};
+
+// A few stock effects.  Each takes the segment to draw in, then its own
+// parameters, then the interval between frames in milliseconds.
+
+// Fill segment with a solid color, once.
+class Adafruit_NeoPixel_Solid : public Adafruit_NeoPixel_Effect {
+ public:
+  Adafruit_NeoPixel_Solid(Adafruit_NeoPixel_Segment &s, uint32_t c);
+  void setColor(uint32_t c);
+ protected:
+  boolean step(void);
+  uint32_t color;
+};
+
+// Fill segment one pixel per frame, then finish.
+class Adafruit_NeoPixel_ColorWipe : public Adafruit_NeoPixel_Effect {
+ public:
+  Adafruit_NeoPixel_ColorWipe(Adafruit_NeoPixel_Segment &s, uint32_t c,
+    uint16_t ms);
+  void setColor(uint32_t c);
+ protected:
+  boolean step(void);
+  uint32_t color;
+};
+
+// Light one random pixel per frame (previous one goes dark).  Endless.
+class Adafruit_NeoPixel_Sparkle : public Adafruit_NeoPixel_Effect {
+ public:
+  Adafruit_NeoPixel_Sparkle(Adafruit_NeoPixel_Segment &s, uint32_t c,
+    uint16_t ms);
+ protected:
+  boolean step(void);
+  void reset(void);
+  uint32_t color;
+  uint16_t last;
+};
+
+// Ramp whole segment from black up to a color over 'steps' frames, then
+// finish.
+class Adafruit_NeoPixel_FadeIn : public Adafruit_NeoPixel_Effect {
+ public:
+  Adafruit_NeoPixel_FadeIn(Adafruit_NeoPixel_Segment &s, uint32_t c,
+    uint16_t steps, uint16_t ms);
+ protected:
+  boolean step(void);
+  uint32_t color;
+  uint16_t steps;
+};
+
+#endif // ADAFRUIT_NEOPIXEL_EFFECT_H
@@ -0,0 +1,118 @@
+/*--------------------------------------------------------------------
+  This file is part of the Adafruit NeoPixel library.
+
+  NeoPixel is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation, either version 3 of
+  the License, or (at your option) any later version.
+
+  NeoPixel is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with NeoPixel.  If not, see
+  <http://www.gnu.org/licenses/>.
+  --------------------------------------------------------------------*/
+
+#ifndef ADAFRUIT_NEOPIXEL_MATH_H
+#define ADAFRUIT_NEOPIXEL_MATH_H
+
+#include <stdint.h>
+
+// Small fixed-point helpers for 8-bit color components, shared by the
+// library's brightness code and available to sketches.  All are inline
+// and stick to 8x8-bit multiplies where possible, which AVR does in a
+// couple of cycles.  The *Buffer() variants are plain loops over raw
+// bytes with no cross-iteration dependencies, so compilers for larger
+// CPUs are free to vectorize them.
+
+// Scale 'c' by (s + 1) / 256.  This is the same math setBrightness() has
+// always used: s = 255 returns c unchanged, s = 0 returns 0, and results
+// in between are rounded down.
+static inline uint8_t neoScale8(uint8_t c, uint8_t s) {
+  return ((uint16_t)c * (uint16_t)(s + 1)) >> 8;
+}
+
+// As neoScale8(), but a nonzero 'c' scaled by a nonzero 's' never drops
+// all the way to 0 (it bottoms out at 1).  Keeps dim pixels from
+// vanishing at low brightness.
+static inline uint8_t neoScale8Video(uint8_t c, uint8_t s) {
+  uint8_t r = neoScale8(c, s);
+  return (!r && c && s) ? 1 : r;
+}
+
+// Saturating add: a + b, clipped at 255.
+static inline uint8_t neoQAdd8(uint8_t a, uint8_t b) {
+  uint16_t t = (uint16_t)a + b;
+  return (t > 255) ? 255 : t;
+}
+
+// Saturating subtract: a - b, clipped at 0.
+static inline uint8_t neoQSub8(uint8_t a, uint8_t b) {
+  return (a > b) ? (a - b) : 0;
+}
+
+// Linear interpolation from 'a' (frac = 0) to 'b' (frac = 255).  Both
+// endpoints are exact; the step toward 'b' is neoScale8() of the
+// difference, so rounding is always toward 'a'.
+static inline uint8_t neoLerp8(uint8_t a, uint8_t b, uint8_t frac) {
+  return (b >= a) ? (a + neoScale8(b - a, frac)) :
+                    (a - neoScale8(a - b, frac));
+}
+
+// Scale a packed 32-bit RGB color, per neoScale8().
+static inline uint32_t neoScaleColor(uint32_t c, uint8_t s) {
+  return ((uint32_t)neoScale8(c >> 16, s) << 16) |
+         ((uint32_t)neoScale8(c >>  8, s) <<  8) |
+                    neoScale8(c      , s);
+}
+
+// Blend two packed 32-bit RGB colors, per neoLerp8() on each component.
+static inline uint32_t neoBlend(uint32_t c1, uint32_t c2, uint8_t frac) {
+  return ((uint32_t)neoLerp8(c1 >> 16, c2 >> 16, frac) << 16) |
+         ((uint32_t)neoLerp8(c1 >>  8, c2 >>  8, frac) <<  8) |
+                    neoLerp8(c1      , c2      , frac);
+}
+
+// neoScale8() every byte in a buffer.
+static inline void neoScaleBuffer(uint8_t *buf, uint16_t n, uint8_t s) {
+  for(uint16_t i=0; i<n; i++) buf[i] = neoScale8(buf[i], s);
+}
+
+// neoQAdd8() each byte of 'src' into 'dst' (e.g. layering effects).
+static inline void neoQAddBuffer(uint8_t *dst, const uint8_t *src,
+  uint16_t n) {
+  for(uint16_t i=0; i<n; i++) dst[i] = neoQAdd8(dst[i], src[i]);
+}
+
+// neoLerp8() each byte of 'dst' toward the matching byte of 'src'.
+static inline void neoLerpBuffer(uint8_t *dst, const uint8_t *src,
+  uint16_t n, uint8_t frac) {
+  for(uint16_t i=0; i<n; i++) dst[i] = neoLerp8(dst[i], src[i], frac);
+}
+
+// Re-scale data previously scaled with neoScale8(c, from) so that it
+// approximates neoScale8(c, to) instead.  This is inherently lossy when
+// scaling up (the low bits are gone), but the result is rounded to
+// nearest and clipped at 255 rather than truncated.  to = 0 always
+// yields 0, matching neoScale8(c, 0) ("off").  Needs a 32-bit multiply
+// per byte, so it's meant for occasional brightness changes, not
+// per-frame use.
+static inline void neoRescaleBuffer(uint8_t *buf, uint16_t n,
+  uint8_t from, uint8_t to) {
+  if(!to) {
+    for(uint16_t i=0; i<n; i++) buf[i] = 0;
+    return;
+  }
+  uint16_t o     = (uint16_t)from + 1,
+           t     = (uint16_t)to   + 1;
+  uint32_t scale = (((uint32_t)t << 8) + (o >> 1)) / o, v; // 8.8 fixed
+  for(uint16_t i=0; i<n; i++) {
+    v      = ((uint32_t)buf[i] * scale + 0x80) >> 8;
+    buf[i] = (v > 255) ? 255 : v;
+  }
+}
+
+#endif // ADAFRUIT_NEOPIXEL_MATH_H
@@ -0,0 +1,96 @@
+/*--------------------------------------------------------------------
+  This file is part of the Adafruit NeoPixel library.
+
+  NeoPixel is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation, either version 3 of
+  the License, or (at your option) any later version.
+
+  NeoPixel is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with NeoPixel.  If not, see
+  <http://www.gnu.org/licenses/>.
+  --------------------------------------------------------------------*/
+
+#ifndef ADAFRUIT_NEOPIXEL_PACE_H
+#define ADAFRUIT_NEOPIXEL_PACE_H
+
+#include <stdint.h>
+
+// Bit pacing loop for outputs timed off a free-running cycle counter
+// (e.g. the ARM DWT CYCCNT register).  'Counter' is anything whose
+// operator() returns the current count as a uint32_t, and 'Pin' has
+// high() and low() methods.  Both are normally tiny inline structs
+// wrapping hardware registers, so this compiles down to the same code
+// as writing the loop out by hand -- but the same logic can also be
+// driven by a simulated counter on a desktop machine.
+//
+// Every rising edge is scheduled at an absolute count, 'period' cycles
+// after the previous one, and each falling edge 'timeLo' or 'timeHi'
+// cycles after its rising edge.  Time spent leaving a wait loop or
+// fetching the next byte only delays an edge by that much; it never
+// carries over into the next bit.  Comparisons use the signed difference
+// of unsigned counts, so counter wraparound is harmless.  Returns once
+// the last bit's full period has elapsed.
+template <class Counter, class Pin>
+static inline void neoPaceBits(Counter &count, Pin &pin,
+  const uint8_t *p, const uint8_t *end,
+  uint32_t timeLo, uint32_t timeHi, uint32_t period) {
+  uint32_t edge = count(), t;
+  uint8_t  pix, mask;
+
+  while(p < end) {
+    pix = *p++;
+    for(mask = 0x80; mask; mask >>= 1) {
+      t = edge + ((pix & mask) ? timeHi : timeLo);
+      while((int32_t)(count() - edge) < 0);
+      pin.high();
+      while((int32_t)(count() - t) < 0);
+      pin.low();
+      edge += period;
+    }
+  }
+  while((int32_t)(count() - edge) < 0); // Wait for last bit
+}
+
+// Cycle counts for neoPaceBits() at clock 'f', straight from the
+// datasheet timings (WS2812B at 800 KHz, WS2811 at 400 KHz).
+#define NEO_CYC_800_T0H(f) ((f) / 2500000) // 0.40 uS
+#define NEO_CYC_800_T1H(f) ((f) / 1250000) // 0.80 uS
+#define NEO_CYC_800(f)     ((f) /  800000) // 1.25 uS per bit
+#define NEO_CYC_400_T0H(f) ((f) / 2000000) // 0.50 uS
+#define NEO_CYC_400_T1H(f) ((f) /  833333) // 1.20 uS
+#define NEO_CYC_400(f)     ((f) /  400000) // 2.50 uS per bit
+
+// Teensy 3.0 delayShort() counts for clock speeds without a hand-tuned
+// table in show().  Each phase's datasheet time (WS2812B at 800 KHz,
+// WS2811 at 400 KHz) is converted to CPU cycles at clock 'f', the fixed
+// overhead of that phase is deducted, and the remainder is divided by
+// the cost of one delayShort() iteration, rounded to nearest.  A low
+// phase costs more than a high one since it also pays for stepping the
+// bit and byte loops.  delayShort(0) would wrap around and stall for
+// ages, so results are clamped to a minimum of 1.  tests/timing_test.cpp
+// sweeps these across clock speeds and checks every phase against the
+// datasheet tolerances; below about 20 MHz the low phases run long, and
+// below about 11 MHz the '0' and '1' highs collapse to the same count
+// (show() refuses to build there).
+#define NEO_DCYC    4 // CPU cycles per delayShort() iteration
+#define NEO_DOVH_HI 3 // CPU cycles of overhead per high phase
+#define NEO_DOVH_LO 8 // CPU cycles of overhead per low phase
+#define NEO_CYCLES(f, ns) ((ns) * ((f) / 1000UL) / 1000000UL)
+#define NEO_DELAY(f, ns, ovh) ((NEO_CYCLES(f, ns) > ((ovh) + NEO_DCYC)) ? \
+  ((NEO_CYCLES(f, ns) - (ovh) + NEO_DCYC / 2) / NEO_DCYC) : 1)
+#define NEO_800_T0H(f) NEO_DELAY(f,  400UL, NEO_DOVH_HI)
+#define NEO_800_T0L(f) NEO_DELAY(f,  850UL, NEO_DOVH_LO)
+#define NEO_800_T1H(f) NEO_DELAY(f,  800UL, NEO_DOVH_HI)
+#define NEO_800_T1L(f) NEO_DELAY(f,  450UL, NEO_DOVH_LO)
+#define NEO_400_T0H(f) NEO_DELAY(f,  500UL, NEO_DOVH_HI)
+#define NEO_400_T0L(f) NEO_DELAY(f, 2000UL, NEO_DOVH_LO)
+#define NEO_400_T1H(f) NEO_DELAY(f, 1200UL, NEO_DOVH_HI)
+#define NEO_400_T1L(f) NEO_DELAY(f, 1300UL, NEO_DOVH_LO)
+
+#endif // ADAFRUIT_NEOPIXEL_PACE_H
@@ -0,0 +1,111 @@
+/*-------------------------------------------------------------------------
+  Segment ('virtual strip') support for the Adafruit NeoPixel library.
+  Splits one physical strip into independently-addressed zones, each with
+  its own pixel numbering, direction and brightness.
+
+  -------------------------------------------------------------------------
+  This file is part of the Adafruit NeoPixel library.
+
+  NeoPixel is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation, either version 3 of
+  the License, or (at your option) any later version.
+
+  NeoPixel is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with NeoPixel.  If not, see
+  <http://www.gnu.org/licenses/>.
+  -------------------------------------------------------------------------*/
+
+#include "Adafruit_NeoPixel_Segment.h"
+
+// Range is clipped to the parent strip; a segment starting past the end
+// of the strip simply has zero pixels.
+Adafruit_NeoPixel_Segment::Adafruit_NeoPixel_Segment(Adafruit_NeoPixel &s,
+  uint16_t f, uint16_t n, boolean reverse) : strip(s), first(f),
+  numLEDs((f >= s.numPixels()) ? 0 :
+    ((n > (s.numPixels() - f)) ? (s.numPixels() - f) : n)),
+  brightness(0), reversed(reverse)
+{
+}
+
+// Convert segment pixel index to parent strip index.  Caller must have
+// already checked n < numLEDs.
+uint16_t Adafruit_NeoPixel_Segment::map(uint16_t n) {
+  return reversed ? (first + numLEDs - 1 - n) : (first + n);
+}
+
+// Issues the WHOLE parent strip, including any other segments on it.
+void Adafruit_NeoPixel_Segment::show(void) {
+  strip.show();
+}
+
+// Set pixel color from separate R,G,B components.  Segment brightness is
+// applied here, parent strip brightness is then applied by the strip.
+void Adafruit_NeoPixel_Segment::setPixelColor(
+ uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+  if(n < numLEDs) {
+    if(brightness) { // See notes in Adafruit_NeoPixel::setBrightness()
+      r = neoScale8(r, brightness - 1);
+      g = neoScale8(g, brightness - 1);
+      b = neoScale8(b, brightness - 1);
+    }
+    strip.setPixelColor(map(n), r, g, b);
+  }
+}
+
+// Set pixel color from 'packed' 32-bit RGB color:
+void Adafruit_NeoPixel_Segment::setPixelColor(uint16_t n, uint32_t c) {
+  setPixelColor(n, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c);
+}
+
+// Set every pixel in the segment (and only those) to the same color.
+void Adafruit_NeoPixel_Segment::fill(uint32_t c) {
+  for(uint16_t i=0; i<numLEDs; i++) setPixelColor(i, c);
+}
+
+void Adafruit_NeoPixel_Segment::clear(void) {
+  uint8_t *ptr = strip.getPixels();
+  if(ptr) memset(&ptr[first * 3], 0, numLEDs * 3);
+}
+
+// Query color from previously-set pixel (returns packed 32-bit RGB value,
+// as stored -- i.e. with both segment and strip brightness applied).
+uint32_t Adafruit_NeoPixel_Segment::getPixelColor(uint16_t n) {
+  return (n < numLEDs) ? strip.getPixelColor(map(n)) : 0;
+}
+
+uint16_t Adafruit_NeoPixel_Segment::numPixels(void) {
+  return numLEDs;
+}
+
+uint16_t Adafruit_NeoPixel_Segment::firstPixel(void) {
+  return first;
+}
+
+Adafruit_NeoPixel &Adafruit_NeoPixel_Segment::getStrip(void) {
+  return strip;
+}
+
+// Flipping direction does not move existing data; it affects subsequent
+// setPixelColor() and getPixelColor() calls only.
+void Adafruit_NeoPixel_Segment::setReversed(boolean reverse) {
+  reversed = reverse;
+}
+
+// Adjust segment brightness; 0=darkest (off), 255=brightest.  Works like
+// the strip-wide setBrightness() (same "lossy" caveats apply) but only
+// re-scales the bytes belonging to this segment.  Segment and strip
+// brightness multiply together.
+void Adafruit_NeoPixel_Segment::setBrightness(uint8_t b) {
+  uint8_t newBrightness = b + 1;
+  if(newBrightness != brightness) {
+    uint8_t *ptr = strip.getPixels();
+    if(ptr) neoRescaleBuffer(&ptr[first * 3], numLEDs * 3, brightness - 1, b);
+    brightness = newBrightness;
+  }
+}
@@ -0,0 +1,73 @@
+/*--------------------------------------------------------------------
+  This file is part of the Adafruit NeoPixel library.
+
+  NeoPixel is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation, either version 3 of
+  the License, or (at your option) any later version.
+
+  NeoPixel is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with NeoPixel.  If not, see
+  <http://www.gnu.org/licenses/>.
+  --------------------------------------------------------------------*/
+
+#ifndef ADAFRUIT_NEOPIXEL_SEGMENT_H
+#define ADAFRUIT_NEOPIXEL_SEGMENT_H
+
+#include "Adafruit_NeoPixel.h"
+
+// A segment is a 'virtual strip' covering a range of pixels on a physical
+// Adafruit_NeoPixel strip.  It holds no pixel data of its own; drawing
+// calls are offset (and optionally reversed) and passed through to the
+// parent strip, so color order is handled there.  Any number of segments
+// can share one strip, and a single show() on either the strip or any of
+// its segments issues all of them at once.
+
+class Adafruit_NeoPixel_Segment {
+
+ public:
+
+  // Constructor: parent strip, index of first pixel, number of pixels,
+  // reverse flag (if true, segment pixel 0 is the LAST pixel of range).
+  Adafruit_NeoPixel_Segment(Adafruit_NeoPixel &s, uint16_t first,
+    uint16_t n, boolean reverse=false);
+
+  void
+    show(void),
+    setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b),
+    setPixelColor(uint16_t n, uint32_t c),
+    fill(uint32_t c),
+    clear(void),
+    setBrightness(uint8_t),
+    setReversed(boolean reverse);
+  uint16_t
+    numPixels(void),
+    firstPixel(void);
+  uint32_t
+    getPixelColor(uint16_t n);
+  Adafruit_NeoPixel
+   &getStrip(void);
+
+ private:
+
+  uint16_t
+    map(uint16_t n);
+
+  Adafruit_NeoPixel
+   &strip;         // Parent strip holding the actual pixel data
+  const uint16_t
+    first,         // Index of first pixel of segment on parent strip
+    numLEDs;       // Number of pixels in segment
+  uint8_t
+    brightness;    // Segment brightness, same encoding as parent's
+  boolean
+    reversed;      // If true, pixel order is flipped within segment
+
+};
+
+#endif // ADAFRUIT_NEOPIXEL_SEGMENT_H
@@ -1,5 +1,6 @@
 
 #include <Adafruit_NeoPixel.h>
+#include <Adafruit_NeoPixel_Effect.h>
 
 // Parameter 1 = number of pixels in strip
 // Parameter 2 = pin number (most are valid)
@@ -13,6 +14,19 @@ int numLEDs = 12;  // number of LEDs in strip
 int dataInput = 6; // the input switch connection from the data line on the strip to the arduino
 
 Adafruit_NeoPixel strip = Adafruit_NeoPixel(numLEDs, dataInput, NEO_GRB + NEO_KHZ800);
+
+// The effects run in the background off engine.tick(), so the switch
+// inputs are checked every time through loop() and a new state takes
+// over right away instead of waiting for the current effect to finish.
+Adafruit_NeoPixel_Segment   all(strip, 0, numLEDs);
+Adafruit_NeoPixel_Engine    engine(strip);
+Adafruit_NeoPixel_FadeIn    fadeRed(all, strip.Color(127,   0,   0), 127, 4); // adjust last value to speed up or slow down fade time
+Adafruit_NeoPixel_Sparkle   flashRed(all, strip.Color(127,   0,   0), 10);
+Adafruit_NeoPixel_ColorWipe chase(all, strip.Color(0,   0,   0), 50);
+Adafruit_NeoPixel_Solid     green(all, strip.Color(0,   125,   0));
+
+int lastSwitchVal = -1;
+boolean chaseOn;
 //****************************************************************************/
 
 void setup() {
@@ -40,82 +54,52 @@ if (sensorVal1 == HIGH) switchVal =1;
 else if (sensorVal4 == HIGH) switchVal =4;  
 else if (sensorVal5 == HIGH) switchVal =5; 
 
- switch (switchVal)  
+ if (switchVal != lastSwitchVal)  // state changed, swap in the new effect
  {
-   case 1: // fade all pixels RED and then off
-         {
-           int j;
-           int i;
-           for (j = 0; j < 127; j++)
-              for (i=0; i < strip.numPixels(); i++)
-              {
-                strip.setPixelColor(i, strip.Color(j,0,0)); //Red
-                strip.show();
-              }
-            delay(4); // adjust this have to speed up or slow down fade time
-         }
+   engine.removeAll();
+   switch (switchVal)  
+   {
+     case 1: // fade all pixels RED and then off
+       all.clear();
+       fadeRed.restart();
+       engine.add(fadeRed);
+       break;
        
-      
-     break;
-     
-   case 4: // random pixel flashes in RED
-     for (int p = 0; p < 20; p++)
-       {
-         
-         colorRnd(strip.Color(127,   0,   0), 10); // Red
-         colorRnd(strip.Color(127,   0,   0), 10); // Red
-       }
-     break;
-     
-   case 5: // YELLOW pixel chace down the strip
-     {
-       colorWipe(strip.Color(0,   0,   0), 50);  // Off
-       strip.show();
-       colorWipe(strip.Color(125,   125,   0), 50);  // Yellow
-        strip.show();
-     }
-     break;
-     
-   default: // all pixels GREEN 
-      {
-     colorWipe(strip.Color(0,   125,   0), 0);  // Green
-      strip.show();
-       }
+     case 4: // random pixel flashes in RED
+       all.clear();
+       flashRed.restart();
+       engine.add(flashRed);
+       break;
        
- } 
-
+     case 5: // YELLOW pixel chace down the strip
+       chaseOn = false;
+       chase.setColor(strip.Color(0,   0,   0));  // Off
+       engine.add(chase);
+       break;
+       
+     default: // all pixels GREEN 
+       green.restart();
+       engine.add(green);
+   }
+   lastSwitchVal = switchVal;
  }
-  
-// blink random leds
-void colorRnd(uint32_t c, uint8_t wait) {
-  int i;
-
-  // Start by turning all pixels off:
-  for(i=0; i<strip.numPixels(); i++) strip.setPixelColor(i, 0);
-
-  // Then display one pixel at a time:
-  //for(i=0; i<5; i++) {
-    int pixelnum = random(numLEDs);
-    strip.setPixelColor(pixelnum, c); // Set new pixel 'on'
-    strip.show();              // Refresh LED states
-    strip.setPixelColor(pixelnum, 0); // Erase pixel, but don't refresh!
-    delay(wait);
-  //}
-
-  strip.show(); // Refresh to turn off last pixel
-}
 
-// Fill the dots progressively along the strip....we don't use
-void colorWipe(uint32_t c, uint8_t wait) {
-  int i;
+ // Repeating states start over once their effect has run through
+ if (switchVal == 1 && fadeRed.done())
+ {
+   all.clear();
+   fadeRed.restart();
+ }
+ else if (switchVal == 5 && chase.done())
+ {
+   chaseOn = !chaseOn;
+   chase.setColor(chaseOn ? strip.Color(125,   125,   0) : strip.Color(0,   0,   0)); // Yellow / Off
+ }
 
-  for (i=0; i < strip.numPixels(); i++) {
-      strip.setPixelColor(i, c);
-      strip.show();
-      delay(wait);
-  }
-}
+ engine.tick();
 
+ }
+  
 
 /* Helper functions */
 
@@ -0,0 +1,73 @@
+/*
+Plays back frames captured with setCapture() on another sketch.
+
+To capture: in the sketch being debugged, add Serial.begin(115200) and
+strip.setCapture(&Serial) to setup(), run it and save everything from the
+serial port to a file (e.g. 'cat /dev/ttyACM0 > frames.bin' on Linux or
+Mac, after setting the port to 115200 baud raw mode).  The file can be
+picked apart on a computer to check exactly what was sent and when.
+
+To replay: load this sketch on a board with the same type of strip, then
+send the file back over the serial port.  Each frame is copied straight
+into the pixel buffer and shown at the same spacing it was recorded with
+(or as fast as the serial port delivers, if that's slower).  Set PIXELS
+and TYPE to match the capturing sketch.
+*/
+
+#include <Adafruit_NeoPixel.h>
+
+#define PIN    6
+#define PIXELS 60
+#define TYPE   (NEO_GRB + NEO_KHZ800)
+
+Adafruit_NeoPixel strip = Adafruit_NeoPixel(PIXELS, PIN, TYPE);
+
+uint32_t lastStamp, lastShow;
+boolean  first = true;
+
+void setup() {
+  Serial.begin(115200);
+  strip.begin();
+  strip.show(); // Initialize all pixels to 'off'
+}
+
+void loop() {
+  if(readByte() != 'F') return; // Not at a record marker; skip until one
+
+  uint32_t stamp = readByte();
+  stamp |= (uint32_t)readByte() <<  8;
+  stamp |= (uint32_t)readByte() << 16;
+  stamp |= (uint32_t)readByte() << 24;
+  readByte();                   // Brightness; already applied to data
+  uint16_t len  = readByte();
+  len          |= (uint16_t)readByte() << 8;
+  uint8_t  type = readByte();
+
+  // Copy data into pixel buffer, dropping any excess if the recording was
+  // from a longer strip.
+  uint8_t *p = strip.getPixels();
+  for(uint16_t i=0; i<len; i++) {
+    uint8_t c = readByte();
+    if(p && (i < PIXELS * 3)) p[i] = c;
+  }
+
+  // Recorded on RGB strip but playing on GRB (or vice versa)?  Swap.
+  if(p && ((type & NEO_COLMASK) != (TYPE & NEO_COLMASK))) {
+    for(uint16_t i=0; (i < len) && (i < PIXELS * 3); i += 3) {
+      uint8_t t = p[i]; p[i] = p[i + 1]; p[i + 1] = t;
+    }
+  }
+
+  // Reproduce original frame spacing
+  if(!first) while((micros() - lastShow) < (stamp - lastStamp));
+  lastShow  = micros();
+  lastStamp = stamp;
+  first     = false;
+  strip.show();
+}
+
+// Wait for and return next byte from serial port
+uint8_t readByte() {
+  while(!Serial.available());
+  return Serial.read();
+}
@@ -0,0 +1,72 @@
+// Host benchmark of the time budget between pixels in show(gen).  Each
+// pixel goes out through its own neoPaceBits() call (as transmit() does
+// on the Teensy cycle-counter path), with the counter advanced by a
+// 'stall' in between standing in for gen(), scaling and call setup.  The
+// longest stall that still decodes as one unbroken frame (decode.h:
+// no gap reaching the 5 uS early latch) is the budget per pixel.  It's
+// reported for a few clocks and must stay at or above the 3.5 uS floor
+// quoted in the show(gen) notes in Adafruit_NeoPixel.cpp.
+
+#include <stdio.h>
+#include <string.h>
+#include "../Adafruit_NeoPixel_Pace.h"
+#include "decode.h"
+#include "sim.h"
+
+#define PIXELS 8
+
+// Send PIXELS pixels at 800 KHz with 'stall' cycles between them;
+// true if the decoded frame is intact with nothing flagged.
+static bool frame(uint32_t hz, uint32_t stall) {
+  static const uint8_t data[PIXELS * 3] = { // Last bits alternate 0/1
+    0x12, 0x34, 0x56, 0xFF, 0x00, 0x81, 0xA5, 0x5A, 0x3C,
+    0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x0F, 0xF0, 0x01,
+    0x80, 0x40, 0x20, 0x10, 0x08, 0x07 };
+  uint8_t    out[sizeof(data)];
+  SimCounter count = { 0, 1, 0, 0 };
+  SimPin     pin;
+  NeoDecoded d;
+  pin.clock = &count;
+  pin.n     = 0;
+
+  for(int i=0; i<PIXELS; i++) {
+    if(i) count.now += stall;
+    neoPaceBits(count, pin, &data[i * 3], &data[i * 3 + 3],
+      NEO_CYC_800_T0H(hz), NEO_CYC_800_T1H(hz), NEO_CYC_800(hz));
+  }
+  neoDecode(pin.rise, pin.fall, pin.n, hz, neoTiming800, out, d);
+  return d.ok() && !memcmp(out, data, sizeof(data));
+}
+
+int main(void) {
+  static const uint32_t clocks[] = { 48000000, 72000000, 96000000,
+    120000000, 180000000 };
+  int failures = 0;
+
+  for(unsigned c=0; c<sizeof(clocks)/sizeof(clocks[0]); c++) {
+    uint32_t hz = clocks[c], lo = 0, hi = hz / 100000; // 0 to 10 uS
+    if(!frame(hz, lo)) {
+      printf("FAIL %lu MHz: no stall at all fails\n",
+        (unsigned long)(hz / 1000000));
+      failures++;
+      continue;
+    }
+    while((hi - lo) > 1) { // Largest stall that still passes
+      uint32_t mid = (lo + hi) / 2;
+      if(frame(hz, mid)) lo = mid;
+      else               hi = mid;
+    }
+    uint32_t ns = neoNanos(lo, hz);
+    printf("budget_test: %3lu MHz, 800 KHz: %5lu cycles = %lu.%02lu uS "
+      "per pixel\n", (unsigned long)(hz / 1000000), (unsigned long)lo,
+      (unsigned long)(ns / 1000), (unsigned long)(ns % 1000 / 10));
+    if(ns < 3500) {
+      printf("FAIL %lu MHz: budget under 3.5 uS\n",
+        (unsigned long)(hz / 1000000));
+      failures++;
+    }
+  }
+
+  if(!failures) puts("budget_test: OK");
+  return failures ? 1 : 0;
+}
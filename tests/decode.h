@@ -0,0 +1,110 @@
+// Bitstream decoder for recorded NeoPixel output.  Takes the rising and
+// falling edge times of each bit -- from a simulated counter here, or
+// from a logic analyzer export converted to the same form -- rebuilds
+// the bytes the LEDs would latch, and flags any bit the datasheet says
+// they might misread:
+//
+//  - high time outside the '0' or '1' window (wrong or ambiguous bit),
+//  - low time shorter than the datasheet minimum,
+//  - an idle gap long enough that some parts latch early, splitting
+//    the frame (the rest of the data lands back at the first pixel).
+//
+// A low time past the datasheet maximum but short of a latch is counted
+// but not treated as an error; every driver tolerates it in practice,
+// and it's what happens between pixels in show(gen).  Extremes of each
+// phase are kept so a backend's worst-case jitter can be reported.
+
+#ifndef NEO_DECODE_H
+#define NEO_DECODE_H
+
+#include <stdint.h>
+
+// Timing window for one bitstream speed, in nanoseconds
+struct NeoTiming {
+  uint32_t t0hMin, t0hMax, // '0' bit high time
+           t1hMin, t1hMax, // '1' bit high time
+           t0lMin, t0lMax, // '0' bit low time
+           t1lMin, t1lMax, // '1' bit low time
+           latch;          // Idle time at which early parts may latch
+};
+
+// WS2812B datasheet, 800 KHz: 0.40/0.85 uS ('0') and 0.80/0.45 uS ('1'),
+// each +/-150 nS.  The datasheet latch is 50 uS, but many later parts
+// latch after roughly 5 uS idle, so that's where gaps are flagged.
+static const NeoTiming neoTiming800 = {
+  250,  550,  650,  950,  700, 1000,  300,  600, 5000 };
+// WS2811 datasheet, 400 KHz: 0.50/2.00 uS ('0') and 1.20/1.30 uS ('1'),
+// each +/-150 nS.
+static const NeoTiming neoTiming400 = {
+  350,  650, 1050, 1350, 1850, 2150, 1150, 1450, 5000 };
+
+struct NeoDecoded {
+  uint16_t bits,     // Bits decoded
+           bytes,    // Whole bytes written to output
+           badHigh,  // High time outside its bit's window
+           shortLow, // Low time under datasheet minimum
+           longLow,  // Low time over datasheet maximum (not an error)
+           latches;  // Gaps at or beyond the early latch time
+  int32_t  firstBad; // Index of first flagged bit, or -1
+  uint32_t hi0Min, hi0Max, hi1Min, hi1Max, // Extremes seen, in nS
+           lo0Min, lo1Min;
+
+  bool ok(void) const { return (firstBad < 0); }
+};
+
+// Convert a cycle count at 'hz' to nanoseconds
+static inline uint32_t neoNanos(uint32_t cycles, uint32_t hz) {
+  return (uint32_t)((uint64_t)cycles * 1000000000ULL / hz);
+}
+
+// Decode 'n' bits whose edges are rise[i] and fall[i], in counts of a
+// clock running at 'hz' (unsigned differences, so counter wraparound is
+// harmless).  Bytes go to 'out', which must hold n / 8 bytes.  Bits are
+// classified by which side of the gap between the two high-time windows
+// they fall on, so a flagged bit still decodes to its likeliest value.
+static void neoDecode(const uint32_t *rise, const uint32_t *fall,
+  uint16_t n, uint32_t hz, const NeoTiming &w, uint8_t *out,
+  NeoDecoded &d) {
+  uint32_t split = (w.t0hMax + w.t1hMin) / 2, hi, lo;
+  uint8_t  byte  = 0;
+  bool     one, bad;
+
+  d.bits   = n;
+  d.bytes  = d.badHigh = d.shortLow = d.longLow = d.latches = 0;
+  d.firstBad = -1;
+  d.hi0Min = d.hi1Min = d.lo0Min = d.lo1Min = 0xFFFFFFFF;
+  d.hi0Max = d.hi1Max = 0;
+
+  for(uint16_t i=0; i<n; i++) {
+    hi  = neoNanos(fall[i] - rise[i], hz);
+    one = (hi >= split);
+    bad = false;
+    if(one) {
+      if(hi < d.hi1Min) d.hi1Min = hi;
+      if(hi > d.hi1Max) d.hi1Max = hi;
+      if((hi < w.t1hMin) || (hi > w.t1hMax)) { d.badHigh++; bad = true; }
+    } else {
+      if(hi < d.hi0Min) d.hi0Min = hi;
+      if(hi > d.hi0Max) d.hi0Max = hi;
+      if((hi < w.t0hMin) || (hi > w.t0hMax)) { d.badHigh++; bad = true; }
+    }
+    if(i < (n - 1)) { // Last bit's low runs into the latch; not checked
+      lo = neoNanos(rise[i + 1] - fall[i], hz);
+      if(one) {
+        if(lo < d.lo1Min) d.lo1Min = lo;
+        if(lo < w.t1lMin) { d.shortLow++; bad = true; }
+        else if(lo > w.t1lMax) d.longLow++;
+      } else {
+        if(lo < d.lo0Min) d.lo0Min = lo;
+        if(lo < w.t0lMin) { d.shortLow++; bad = true; }
+        else if(lo > w.t0lMax) d.longLow++;
+      }
+      if(lo >= w.latch) { d.latches++; bad = true; }
+    }
+    if(bad && (d.firstBad < 0)) d.firstBad = i;
+    byte = (byte << 1) | one;
+    if((i & 7) == 7) out[d.bytes++] = byte;
+  }
+}
+
+#endif // NEO_DECODE_H
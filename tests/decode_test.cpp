@@ -0,0 +1,92 @@
+// Host check of the bitstream decoder in decode.h, on hand-built edge
+// timelines: a clean stream must decode exactly with nothing flagged,
+// and each kind of timing fault must be caught at the bit where it was
+// injected.  Times are in nanoseconds (a 1 GHz 'clock').
+
+#include <stdio.h>
+#include <string.h>
+#include "decode.h"
+
+#define HZ 1000000000UL
+
+static const uint8_t data[] = { 0xA5, 0x0F, 0xFF, 0x00 };
+static uint32_t      rise[32], fall[32];
+static int           failures = 0;
+
+// Lay out 'data' with the nominal datasheet times of 'w'
+static void build(const NeoTiming &w) {
+  uint32_t t = 0, hi, lo;
+  for(int i=0; i<32; i++) {
+    if((data[i / 8] << (i % 8)) & 0x80) {
+      hi = (w.t1hMin + w.t1hMax) / 2;
+      lo = (w.t1lMin + w.t1lMax) / 2;
+    } else {
+      hi = (w.t0hMin + w.t0hMax) / 2;
+      lo = (w.t0lMin + w.t0lMax) / 2;
+    }
+    rise[i] = t;
+    fall[i] = t + hi;
+    t       = fall[i] + lo;
+  }
+}
+
+// Decode and compare against the expected first flagged bit (-1 = none)
+static void expect(const char *what, const NeoTiming &w, int32_t bad) {
+  uint8_t    out[4];
+  NeoDecoded d;
+  neoDecode(rise, fall, 32, HZ, w, out, d);
+  if((d.bytes != 4) || memcmp(out, data, 4)) {
+    printf("FAIL %s: decoded %02X %02X %02X %02X\n", what,
+      out[0], out[1], out[2], out[3]);
+    failures++;
+  } else if(d.firstBad != bad) {
+    printf("FAIL %s: first bad bit %ld, expected %ld\n", what,
+      (long)d.firstBad, (long)bad);
+    failures++;
+  }
+}
+
+// Move every edge from bit 'i' onward by 'dt' nS
+static void shift(int i, int32_t dt) {
+  for(; i<32; i++) { rise[i] += dt; fall[i] += dt; }
+}
+
+int main(void) {
+  const NeoTiming *speed[] = { &neoTiming800, &neoTiming400 };
+
+  for(int s=0; s<2; s++) {
+    const NeoTiming &w = *speed[s];
+
+    build(w);
+    expect("clean", w, -1);
+
+    build(w);                            // Bit 0 is a '1'
+    fall[0] = rise[0] + w.t1hMax + 50;
+    shift(1, 50);
+    expect("long T1H", w, 0);
+
+    build(w);                            // Bit 1 is a '0'
+    fall[1] = rise[1] + w.t0hMin - 50;
+    expect("short T0H", w, 1);
+
+    build(w);                            // Bit 2's low
+    shift(3, (int32_t)w.t1lMin - (int32_t)(rise[3] - fall[2]) - 10);
+    expect("short T1L", w, 2);
+
+    build(w);                            // Stretched low, no latch
+    shift(8, 2000);
+    expect("long low", w, -1);
+
+    build(w);                            // Early latch mid-frame
+    shift(16, w.latch);
+    expect("latch gap", w, 15);
+  }
+
+  // Counts that wrap around 2^32 decode the same
+  build(neoTiming800);
+  shift(0, 0xFFFFF000UL);
+  expect("wraparound", neoTiming800, -1);
+
+  if(!failures) puts("decode_test: OK");
+  return failures ? 1 : 0;
+}
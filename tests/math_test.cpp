@@ -0,0 +1,65 @@
+// Host check of the rounding rules documented in Adafruit_NeoPixel_Math.h.
+// Sweeps are exhaustive where cheap (every component and scale value).
+
+#include <stdio.h>
+#include "../Adafruit_NeoPixel_Math.h"
+
+static int failures = 0;
+
+#define CHECK(cond, fmt, a, b, c) \
+  if(!(cond)) { \
+    if(++failures <= 10) printf("FAIL %s: " fmt "\n", #cond, a, b, c); \
+  }
+
+int main(void) {
+  int     a, b, c;
+  uint8_t v;
+
+  for(c=0; c<256; c++) {
+    // neoScale8: 255 passes through, 0 is off, never exceeds input
+    CHECK(neoScale8(c, 255) == c, "c=%d%s%s", c, "", "");
+    CHECK(neoScale8(c, 0)   == 0, "c=%d%s%s", c, "", "");
+    for(b=0; b<256; b++) {
+      v = neoScale8(c, b);
+      CHECK(v <= c, "c=%d s=%d -> %d", c, b, v);
+      CHECK(v == ((c * (b + 1)) >> 8), "c=%d s=%d -> %d", c, b, v);
+      // neoScale8Video: nonzero in, nonzero scale -> nonzero out
+      CHECK(!c || !b || neoScale8Video(c, b), "c=%d s=%d%s", c, b, "");
+      // Saturating math
+      CHECK(neoQAdd8(c, b) == ((c + b > 255) ? 255 : c + b),
+        "a=%d b=%d -> %d", c, b, neoQAdd8(c, b));
+      CHECK(neoQSub8(c, b) == ((c > b) ? c - b : 0),
+        "a=%d b=%d -> %d", c, b, neoQSub8(c, b));
+      // neoLerp8 endpoints are exact
+      CHECK((neoLerp8(c, b, 0) == c) && (neoLerp8(c, b, 255) == b),
+        "a=%d b=%d%s", c, b, "");
+    }
+  }
+
+  for(a=0; a<256; a++) {     // 'from' brightness
+    for(c=0; c<256; c++) {   // original component
+      // Brightness 0 is off, whatever was there before
+      v = neoScale8(c, a);
+      neoRescaleBuffer(&v, 1, a, 0);
+      CHECK(v == 0, "from=%d c=%d -> %d", a, c, v);
+      // Same brightness is a no-op
+      v = neoScale8(c, a);
+      neoRescaleBuffer(&v, 1, a, a);
+      CHECK(v == neoScale8(c, a), "from=%d c=%d -> %d", a, c, v);
+      // Scaling down from full lands within 1 of a direct neoScale8()
+      v = c;
+      neoRescaleBuffer(&v, 1, 255, a);
+      b = v - neoScale8(c, a);
+      CHECK((b >= -1) && (b <= 1), "to=%d c=%d -> %d", a, c, v);
+    }
+  }
+  // Round trip full -> half -> full stays within 1
+  for(c=0; c<256; c++) {
+    v = neoScale8(c, 127);
+    neoRescaleBuffer(&v, 1, 127, 255);
+    CHECK((v - c >= -1) && (v - c <= 1), "c=%d -> %d%s", c, v, "");
+  }
+
+  if(!failures) puts("math_test: OK");
+  return failures ? 1 : 0;
+}
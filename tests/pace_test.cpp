@@ -0,0 +1,66 @@
+// Host check of neoPaceBits() against a simulated cycle counter.
+// Each counter read advances by a varying number of cycles (as cache
+// misses and interrupt-free loop overhead would).  The recorded edges
+// are run through the decoder in decode.h, which must get the original
+// bytes back with every bit inside the datasheet timing window, and the
+// last edge must still be within one read of its absolute schedule --
+// i.e. jitter never accumulates from bit to bit -- including across
+// counter wraparound.
+
+#include <stdio.h>
+#include <string.h>
+#include "../Adafruit_NeoPixel_Pace.h"
+#include "decode.h"
+#include "sim.h"
+
+static int failures = 0;
+
+static void check(uint32_t hz, const NeoTiming &w, uint32_t start,
+  uint32_t timeLo, uint32_t timeHi, uint32_t period) {
+  const uint8_t data[] = { 0xA5, 0x0F, 0xFF, 0x00, 0x3C, 0x81, 0x7E, 0x12 };
+  uint8_t       out[sizeof(data)];
+  SimCounter    count = { start, start, 0, 0 };
+  SimPin        pin;
+  NeoDecoded    d;
+  pin.clock = &count;
+  pin.n     = 0;
+
+  neoPaceBits(count, pin, data, data + sizeof(data), timeLo, timeHi,
+    period);
+
+  if(pin.n != 64) {
+    printf("FAIL start=%lu: %d bits sent\n", (unsigned long)start, pin.n);
+    failures++;
+    return;
+  }
+  neoDecode(pin.rise, pin.fall, 64, hz, w, out, d);
+  if(!d.ok() || memcmp(out, data, sizeof(data))) {
+    printf("FAIL %lu MHz start=%lu: first bad bit %ld, "
+      "T0H %lu-%lu T1H %lu-%lu nS\n", (unsigned long)(hz / 1000000),
+      (unsigned long)start, (long)d.firstBad,
+      (unsigned long)d.hi0Min, (unsigned long)d.hi0Max,
+      (unsigned long)d.hi1Min, (unsigned long)d.hi1Max);
+    failures++;
+  }
+  uint32_t t0 = count.first;
+  if((pin.rise[63] - (t0 + 63 * period)) > 7) {
+    printf("FAIL start=%lu: last bit drifted +%ld\n",
+      (unsigned long)start, (long)(pin.rise[63] - (t0 + 63 * period)));
+    failures++;
+  }
+  if((int32_t)(count.now - (t0 + 64 * period)) < 0) {
+    printf("FAIL start=%lu: returned before last bit period\n",
+      (unsigned long)start);
+    failures++;
+  }
+}
+
+int main(void) {
+  check(48000000, neoTiming800, 0, 19, 38, 60);   // 800 KHz at 48 MHz
+  check(96000000, neoTiming800, 0, 38, 76, 120);  // 800 KHz at 96 MHz
+  check(96000000, neoTiming400, 0, 48, 115, 240); // 400 KHz at 96 MHz
+  check(48000000, neoTiming800, 0xFFFFFF00UL,     // Counter wraps
+    19, 38, 60);                                  // mid-frame
+  if(!failures) puts("pace_test: OK");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+// Simulated cycle counter and output pin for driving neoPaceBits() on
+// the host.  Each counter read advances by a varying 1-7 cycles (as
+// cache misses and loop overhead would), and the pin records the count
+// at every rising and falling edge for decode.h to check.
+
+#ifndef NEO_SIM_H
+#define NEO_SIM_H
+
+#include <stdint.h>
+
+struct SimCounter {
+  uint32_t now, seed, first, reads;
+  uint32_t operator()() {
+    seed = seed * 1103515245UL + 12345UL;
+    now += 1 + ((seed >> 16) % 7); // 1 to 7 cycles per read
+    if(!reads++) first = now;      // Schedule origin
+    return now;
+  }
+};
+
+struct SimPin {
+  SimCounter *clock;
+  uint32_t    rise[256], fall[256];
+  int         n;
+  void high(void) { rise[n] = clock->now; }
+  void low(void)  { fall[n++] = clock->now; }
+};
+
+#endif // NEO_SIM_H
@@ -0,0 +1,84 @@
+// Host sweep of the Teensy 3.0 delayShort() counts derived by the
+// NEO_800_xxx() and NEO_400_xxx() macros in Adafruit_NeoPixel_Pace.h.
+// For each clock from 20 to 240 MHz, the counts are turned back into
+// phase times using the same cycle costs the macros assume, and every
+// phase must land within the datasheet tolerance (decode.h).  The delay
+// loop is also simulated over a test pattern and the edges decoded, to
+// confirm the bytes come back intact.  Below 20 MHz the fixed loop
+// overhead alone exceeds the '1' low window, so the sweep starts there.
+
+#include <stdio.h>
+#include <string.h>
+#include "../Adafruit_NeoPixel_Pace.h"
+#include "decode.h"
+
+static int failures = 0;
+
+// Cycles spent in one phase for a given delayShort() count
+static uint32_t phase(uint32_t count, uint32_t ovh) {
+  return count * NEO_DCYC + ovh;
+}
+
+static void within(uint32_t f, const char *name, uint32_t count,
+  uint32_t ovh, uint32_t lo, uint32_t hi) {
+  uint32_t ns = neoNanos(phase(count, ovh), f);
+  if((ns < lo) || (ns > hi)) {
+    if(++failures <= 10) printf("FAIL %lu Hz %s: count %lu = %lu nS, "
+      "want %lu-%lu\n", (unsigned long)f, name, (unsigned long)count,
+      (unsigned long)ns, (unsigned long)lo, (unsigned long)hi);
+  }
+}
+
+// Simulate the show() delayShort() loop and decode the result
+static void simulate(uint32_t f, const NeoTiming &w, uint32_t t0h,
+  uint32_t t0l, uint32_t t1h, uint32_t t1l) {
+  const uint8_t data[] = { 0xA5, 0x0F, 0xFF, 0x00, 0x3C, 0x81, 0x7E, 0x12 };
+  uint32_t      rise[64], fall[64], t = 0;
+  uint8_t       out[sizeof(data)];
+  NeoDecoded    d;
+
+  for(int i=0; i<64; i++) {
+    bool one = (data[i / 8] << (i % 8)) & 0x80;
+    rise[i] = t;
+    fall[i] = t + phase(one ? t1h : t0h, NEO_DOVH_HI);
+    t       = fall[i] + phase(one ? t1l : t0l, NEO_DOVH_LO);
+  }
+  neoDecode(rise, fall, 64, f, w, out, d);
+  if(!d.ok() || memcmp(out, data, sizeof(data))) {
+    if(++failures <= 10) printf("FAIL %lu Hz: decode, first bad bit %ld\n",
+      (unsigned long)f, (long)d.firstBad);
+  }
+}
+
+int main(void) {
+  for(uint32_t f=20000000UL; f<=240000000UL; f+=1000000UL) {
+    const NeoTiming &a = neoTiming800, &b = neoTiming400;
+    within(f, "800 T0H", NEO_800_T0H(f), NEO_DOVH_HI, a.t0hMin, a.t0hMax);
+    within(f, "800 T0L", NEO_800_T0L(f), NEO_DOVH_LO, a.t0lMin, a.t0lMax);
+    within(f, "800 T1H", NEO_800_T1H(f), NEO_DOVH_HI, a.t1hMin, a.t1hMax);
+    within(f, "800 T1L", NEO_800_T1L(f), NEO_DOVH_LO, a.t1lMin, a.t1lMax);
+    within(f, "400 T0H", NEO_400_T0H(f), NEO_DOVH_HI, b.t0hMin, b.t0hMax);
+    within(f, "400 T0L", NEO_400_T0L(f), NEO_DOVH_LO, b.t0lMin, b.t0lMax);
+    within(f, "400 T1H", NEO_400_T1H(f), NEO_DOVH_HI, b.t1hMin, b.t1hMax);
+    within(f, "400 T1L", NEO_400_T1L(f), NEO_DOVH_LO, b.t1lMin, b.t1lMax);
+    simulate(f, a, NEO_800_T0H(f), NEO_800_T0L(f),
+      NEO_800_T1H(f), NEO_800_T1L(f));
+    simulate(f, b, NEO_400_T0H(f), NEO_400_T0L(f),
+      NEO_400_T1H(f), NEO_400_T1L(f));
+  }
+
+  // show() has an #error for clocks where the '0' and '1' highs come
+  // out the same; make sure that's where the sweep above can't reach
+  // and that it does trip at clocks too slow to work (below ~11 MHz).
+  for(uint32_t f=8000000UL; f<=240000000UL; f+=1000000UL) {
+    bool same = (NEO_800_T0H(f) >= NEO_800_T1H(f)) ||
+                (NEO_400_T0H(f) >= NEO_400_T1H(f));
+    if(same != (f < 12000000UL)) {
+      if(++failures <= 10) printf("FAIL %lu Hz: highs %s\n",
+        (unsigned long)f, same ? "collapse" : "distinct");
+    }
+  }
+
+  if(!failures) puts("timing_test: OK");
+  return failures ? 1 : 0;
+}